@@ -7,9 +7,15 @@
 #include <vector>
 #include <cstdlib>
 #include <ctime>
-#include <deque>
 #include <algorithm>
 #include <fstream> 
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdio>
 
 using namespace std;
 using namespace sf;
@@ -22,13 +28,37 @@ enum class GameState
     GameOver
 };
 
+const int ACCEL_X_INDEX = 21;
+const int ACCEL_Y_INDEX = 22;
+const int ACCEL_Z_INDEX = 23;
+const int GYRO_TIMESTAMP_INDEX = 24;
 const int GYRO_X_INDEX = 25; 
 const int GYRO_Y_INDEX = 26;
 const int GYRO_Z_INDEX = 27;
 
+const double TILT_FILTER_TIME_CONSTANT = 0.5;
+const double TILT_GRAVITY_AXIS_LEAK_TIME = 10.0;
+const double NOMINAL_SAMPLE_PERIOD = 0.01;
+// At this gain the +-0.5 speed dead zone is only ~0.083 rad; the gravity-axis
+// leak keeps residual gyro bias from creeping past it.
+const double TILT_CONTROL_GAIN = 6.0;
+
 const float MAX_ZOOM_OUT = 2.0f; 
+const float MIN_ZOOM_IN = 0.5f;
 const float BUFFER_Y_FACTOR = 1.0f; 
 
+const unsigned int ENGINE_SAMPLE_RATE = 44100;
+const size_t ENGINE_CHUNK_SIZE = 256; 
+
+const char *const METRICS_FILE = "metrics.prom";
+const int METRICS_FLUSH_SECONDS = 5;
+
+const float FRAME_BUDGET = 1.0f / 60.0f;
+const float MIN_RENDER_SCALE = 0.5f;
+
+const char *const GHOST_FILE = "ghost.trj";
+const char *const GHOST_RECORDING_FILE = "ghost.trj.tmp";
+
 vector<string> split(const string &s, char delimiter)
 {
     vector<string> tokens;
@@ -81,6 +111,701 @@ private:
     Text text;
 };
 
+// Synthesizes the engine tone on the audio thread. The game loop only writes
+// the two atomics; each chunk ramps from the previous values to the latest
+// ones to avoid clicks. SoundStream keeps three chunks queued, so with
+// 256-sample chunks a speed change is fully heard within about 17 ms.
+class EngineSound : public SoundStream
+{
+public:
+    EngineSound(float minSpeed, float maxSpeed)
+        : minSpeed(minSpeed), maxSpeed(maxSpeed), speed(minSpeed), steering(0.0f),
+          lastSpeed(minSpeed), lastSteering(0.0f), phase(0.0), noiseState(22222u)
+    {
+        initialize(1, ENGINE_SAMPLE_RATE);
+    }
+
+    ~EngineSound()
+    {
+        stop();
+    }
+
+    void setSpeed(float value)
+    {
+        speed.store(value, memory_order_relaxed);
+    }
+
+    void setSteering(float value)
+    {
+        steering.store(value, memory_order_relaxed);
+    }
+
+private:
+    bool onGetData(Chunk &data) override
+    {
+        const double twoPi = 6.283185307179586;
+
+        float targetSpeed = speed.load(memory_order_relaxed);
+        float targetSteering = clamp(steering.load(memory_order_relaxed), -1.0f, 1.0f);
+
+        for (size_t i = 0; i < ENGINE_CHUNK_SIZE; ++i)
+        {
+            float t = static_cast<float>(i + 1) / ENGINE_CHUNK_SIZE;
+            float s = lastSpeed + (targetSpeed - lastSpeed) * t;
+            float steer = lastSteering + (targetSteering - lastSteering) * t;
+
+            double load = clamp((s - minSpeed) / (maxSpeed - minSpeed), 0.0f, 1.0f);
+            double frequency = 35.0 + 85.0 * load;
+
+            phase += frequency / ENGINE_SAMPLE_RATE;
+            if (phase >= 1.0)
+                phase -= 1.0;
+
+            // Fundamental plus the firing harmonics of a four-cylinder engine,
+            // getting harsher as the load rises.
+            double tone = 0.55 * sin(twoPi * phase) +
+                          (0.20 + 0.15 * load) * sin(2.0 * twoPi * phase) +
+                          (0.10 + 0.15 * load) * sin(4.0 * twoPi * phase);
+
+            noiseState = noiseState * 1664525u + 1013904223u;
+            double noise = static_cast<double>(noiseState >> 8) / 8388608.0 - 1.0;
+            double scrub = (0.05 + 0.25 * fabs(steer)) * noise;
+
+            double amplitude = 0.35 + 0.45 * load;
+            double sample = clamp((tone + scrub) * amplitude, -1.0, 1.0);
+            samples[i] = static_cast<Int16>(sample * 32767.0);
+        }
+
+        lastSpeed = targetSpeed;
+        lastSteering = targetSteering;
+
+        data.samples = samples;
+        data.sampleCount = ENGINE_CHUNK_SIZE;
+        return true;
+    }
+
+    void onSeek(Time) override
+    {
+        phase = 0.0;
+        lastSpeed = speed.load(memory_order_relaxed);
+        lastSteering = 0.0f;
+    }
+
+    const float minSpeed;
+    const float maxSpeed;
+    atomic<float> speed;
+    atomic<float> steering;
+
+    float lastSpeed;
+    float lastSteering;
+    double phase;
+    uint32_t noiseState;
+    Int16 samples[ENGINE_CHUNK_SIZE];
+};
+
+// Complementary filter fusing gyro rates with the accelerometer's gravity
+// direction into tilt angles (radians) about each device axis, relative to
+// the pose held during calibration. Integrating the gyro gives a smooth
+// angle and the gravity reference pulls it back so it cannot drift. Gravity
+// says nothing about rotation around itself, so that component comes from
+// the calibrated gyro alone with a slow leak (TILT_GRAVITY_AXIS_LEAK_TIME):
+// a held tilt there fades over ~10 s, and residual bias b settles at
+// b * 10 s instead of growing without limit. Fixed size, no allocations,
+// one update per sample.
+class TiltFilter
+{
+public:
+    void reset(double accelX, double accelY, double accelZ)
+    {
+        double norm = sqrt(accelX * accelX + accelY * accelY + accelZ * accelZ);
+        if (norm > 0.0)
+        {
+            referenceX = accelX / norm;
+            referenceY = accelY / norm;
+            referenceZ = accelZ / norm;
+        }
+        angleX = angleY = angleZ = 0.0;
+        lastTimestamp = -1.0;
+    }
+
+    // Rates use the game's sign convention (negated, bias removed) and the
+    // accelerometer is in G.
+    void update(double rateX, double rateY, double rateZ,
+                double accelX, double accelY, double accelZ, double timestamp)
+    {
+        double dt = timestamp - lastTimestamp;
+        if (lastTimestamp < 0.0 || dt <= 0.0 || dt > 0.1)
+            dt = NOMINAL_SAMPLE_PERIOD;
+        lastTimestamp = timestamp;
+
+        angleX += rateX * dt;
+        angleY += rateY * dt;
+        angleZ += rateZ * dt;
+
+        double leak = dt / (TILT_GRAVITY_AXIS_LEAK_TIME + dt);
+        double along = angleX * referenceX + angleY * referenceY + angleZ * referenceZ;
+        angleX -= leak * along * referenceX;
+        angleY -= leak * along * referenceY;
+        angleZ -= leak * along * referenceZ;
+
+        // Only trust the accelerometer while it measures roughly 1 G; under
+        // hard linear acceleration it no longer points along gravity.
+        double norm = sqrt(accelX * accelX + accelY * accelY + accelZ * accelZ);
+        if (norm < 0.75 || norm > 1.25)
+            return;
+
+        accelX /= norm;
+        accelY /= norm;
+        accelZ /= norm;
+
+        // For small rotations the reference x current gravity cross product
+        // is the rotation vector in the game's sign convention.
+        double gravityAngleX = referenceY * accelZ - referenceZ * accelY;
+        double gravityAngleY = referenceZ * accelX - referenceX * accelZ;
+        double gravityAngleZ = referenceX * accelY - referenceY * accelX;
+
+        // Blend weight from a time constant rather than a per-sample factor,
+        // so the filter responds the same at any sensor rate.
+        double alpha = TILT_FILTER_TIME_CONSTANT / (TILT_FILTER_TIME_CONSTANT + dt);
+
+        // The gravity angle has no component along the reference, so carry
+        // that part of the gyro angle over unchanged instead of letting it
+        // decay quickly; in the landscape pose that axis drives the speed.
+        along = angleX * referenceX + angleY * referenceY + angleZ * referenceZ;
+
+        angleX = alpha * angleX + (1.0 - alpha) * (gravityAngleX + along * referenceX);
+        angleY = alpha * angleY + (1.0 - alpha) * (gravityAngleY + along * referenceY);
+        angleZ = alpha * angleZ + (1.0 - alpha) * (gravityAngleZ + along * referenceZ);
+    }
+
+    double getAngleX() const { return angleX; }
+    double getAngleY() const { return angleY; }
+    double getAngleZ() const { return angleZ; }
+
+private:
+    double referenceX = 0.0;
+    double referenceY = 0.0;
+    double referenceZ = -1.0;
+    double angleX = 0.0;
+    double angleY = 0.0;
+    double angleZ = 0.0;
+    double lastTimestamp = -1.0;
+};
+
+// Health counters for unattended deployments. Every update on the render
+// thread is a single relaxed atomic add; a background thread periodically
+// writes them to METRICS_FILE in the Prometheus text exposition format.
+class Metrics
+{
+public:
+    static const size_t FRAME_BUCKETS = 9;
+
+    explicit Metrics(const string &path)
+        : path(path), running(true)
+    {
+        flusher = thread(&Metrics::run, this);
+    }
+
+    ~Metrics()
+    {
+        {
+            lock_guard<mutex> lock(flushMutex);
+            running = false;
+        }
+        flushCondition.notify_one();
+        flusher.join();
+        flush();
+    }
+
+    void countFrame(float frameSeconds)
+    {
+        size_t bucket = 0;
+        while (bucket < FRAME_BUCKETS && frameSeconds > frameBucketBounds[bucket])
+            ++bucket;
+        frameBuckets[bucket].fetch_add(1, memory_order_relaxed);
+        frameMicrosSum.fetch_add(static_cast<uint64_t>(frameSeconds * 1e6f), memory_order_relaxed);
+        frames.fetch_add(1, memory_order_relaxed);
+    }
+
+    void countBytesReceived(size_t bytes, bool bufferFilled)
+    {
+        bytesReceived.fetch_add(bytes, memory_order_relaxed);
+        if (bufferFilled)
+            fullReads.fetch_add(1, memory_order_relaxed);
+    }
+
+    void countLine()
+    {
+        linesReceived.fetch_add(1, memory_order_relaxed);
+    }
+
+    void countParseError()
+    {
+        parseErrors.fetch_add(1, memory_order_relaxed);
+    }
+
+    void countIncompleteLine()
+    {
+        incompleteLines.fetch_add(1, memory_order_relaxed);
+    }
+
+    void countDisconnect()
+    {
+        disconnects.fetch_add(1, memory_order_relaxed);
+    }
+
+    void observeCalibration(float seconds)
+    {
+        calibrations.fetch_add(1, memory_order_relaxed);
+        calibrationMicrosSum.fetch_add(static_cast<uint64_t>(seconds * 1e6f), memory_order_relaxed);
+    }
+
+    void observeSessionScore(float score)
+    {
+        sessions.fetch_add(1, memory_order_relaxed);
+        sessionScoreSum.fetch_add(static_cast<uint64_t>(score), memory_order_relaxed);
+        lastSessionScore.store(score, memory_order_relaxed);
+    }
+
+private:
+    void run()
+    {
+        unique_lock<mutex> lock(flushMutex);
+        while (running)
+        {
+            flushCondition.wait_for(lock, chrono::seconds(METRICS_FLUSH_SECONDS));
+            if (running)
+                flush();
+        }
+    }
+
+    void flush()
+    {
+        // Write next to the target and rename so scrapers never see a
+        // half-written file.
+        string tmpPath = path + ".tmp";
+        ofstream out(tmpPath);
+        if (!out.is_open())
+        {
+            cout << "[ERROR] Unable to write metrics." << endl;
+            return;
+        }
+
+        out << "# TYPE car_game_frames_total counter\n"
+            << "car_game_frames_total " << frames.load(memory_order_relaxed) << "\n";
+
+        out << "# TYPE car_game_frame_seconds histogram\n";
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < FRAME_BUCKETS; ++i)
+        {
+            cumulative += frameBuckets[i].load(memory_order_relaxed);
+            out << "car_game_frame_seconds_bucket{le=\"" << frameBucketBounds[i] << "\"} " << cumulative << "\n";
+        }
+        cumulative += frameBuckets[FRAME_BUCKETS].load(memory_order_relaxed);
+        out << "car_game_frame_seconds_bucket{le=\"+Inf\"} " << cumulative << "\n"
+            << "car_game_frame_seconds_sum " << frameMicrosSum.load(memory_order_relaxed) / 1e6 << "\n"
+            << "car_game_frame_seconds_count " << cumulative << "\n";
+
+        out << "# TYPE car_game_socket_received_bytes_total counter\n"
+            << "car_game_socket_received_bytes_total " << bytesReceived.load(memory_order_relaxed) << "\n"
+            << "# TYPE car_game_socket_full_reads_total counter\n"
+            << "car_game_socket_full_reads_total " << fullReads.load(memory_order_relaxed) << "\n"
+            << "# TYPE car_game_socket_lines_total counter\n"
+            << "car_game_socket_lines_total " << linesReceived.load(memory_order_relaxed) << "\n"
+            << "# TYPE car_game_parse_errors_total counter\n"
+            << "car_game_parse_errors_total " << parseErrors.load(memory_order_relaxed) << "\n"
+            << "# TYPE car_game_incomplete_lines_total counter\n"
+            << "car_game_incomplete_lines_total " << incompleteLines.load(memory_order_relaxed) << "\n"
+            << "# TYPE car_game_disconnects_total counter\n"
+            << "car_game_disconnects_total " << disconnects.load(memory_order_relaxed) << "\n";
+
+        out << "# TYPE car_game_calibration_seconds summary\n"
+            << "car_game_calibration_seconds_sum " << calibrationMicrosSum.load(memory_order_relaxed) / 1e6 << "\n"
+            << "car_game_calibration_seconds_count " << calibrations.load(memory_order_relaxed) << "\n";
+
+        out << "# TYPE car_game_session_score summary\n"
+            << "car_game_session_score_sum " << sessionScoreSum.load(memory_order_relaxed) << "\n"
+            << "car_game_session_score_count " << sessions.load(memory_order_relaxed) << "\n"
+            << "# TYPE car_game_last_session_score gauge\n"
+            << "car_game_last_session_score " << lastSessionScore.load(memory_order_relaxed) << "\n";
+
+        out.close();
+        if (rename(tmpPath.c_str(), path.c_str()) != 0)
+        {
+            cout << "[ERROR] Unable to publish metrics." << endl;
+        }
+    }
+
+    const float frameBucketBounds[FRAME_BUCKETS] = { 0.008f, 0.012f, 0.016f, 0.017f, 0.020f, 0.025f, 0.033f, 0.050f, 0.100f };
+
+    atomic<uint64_t> frames{0};
+    atomic<uint64_t> frameBuckets[FRAME_BUCKETS + 1] = {};
+    atomic<uint64_t> frameMicrosSum{0};
+    atomic<uint64_t> bytesReceived{0};
+    atomic<uint64_t> fullReads{0};
+    atomic<uint64_t> linesReceived{0};
+    atomic<uint64_t> parseErrors{0};
+    atomic<uint64_t> incompleteLines{0};
+    atomic<uint64_t> disconnects{0};
+    atomic<uint64_t> calibrations{0};
+    atomic<uint64_t> calibrationMicrosSum{0};
+    atomic<uint64_t> sessions{0};
+    atomic<uint64_t> sessionScoreSum{0};
+    atomic<float> lastSessionScore{0.0f};
+
+    string path;
+    bool running;
+    mutex flushMutex;
+    condition_variable flushCondition;
+    thread flusher;
+};
+
+// Box-filters an image down to the given size, averaging with premultiplied
+// alpha so transparent pixels don't darken the sprite edges.
+Image downscaleImage(const Image &source, Vector2u size)
+{
+    Vector2u sourceSize = source.getSize();
+    const Uint8 *in = source.getPixelsPtr();
+    vector<Uint8> out(size.x * size.y * 4);
+
+    for (unsigned int y = 0; y < size.y; ++y)
+    {
+        unsigned int y0 = y * sourceSize.y / size.y;
+        unsigned int y1 = max(y0 + 1, (y + 1) * sourceSize.y / size.y);
+        for (unsigned int x = 0; x < size.x; ++x)
+        {
+            unsigned int x0 = x * sourceSize.x / size.x;
+            unsigned int x1 = max(x0 + 1, (x + 1) * sourceSize.x / size.x);
+
+            uint64_t r = 0, g = 0, b = 0, a = 0;
+            for (unsigned int sy = y0; sy < y1; ++sy)
+            {
+                for (unsigned int sx = x0; sx < x1; ++sx)
+                {
+                    const Uint8 *pixel = in + (sy * sourceSize.x + sx) * 4;
+                    r += pixel[0] * pixel[3];
+                    g += pixel[1] * pixel[3];
+                    b += pixel[2] * pixel[3];
+                    a += pixel[3];
+                }
+            }
+
+            Uint8 *pixel = &out[(y * size.x + x) * 4];
+            uint64_t count = (y1 - y0) * (x1 - x0);
+            pixel[0] = static_cast<Uint8>(a ? r / a : 0);
+            pixel[1] = static_cast<Uint8>(a ? g / a : 0);
+            pixel[2] = static_cast<Uint8>(a ? b / a : 0);
+            pixel[3] = static_cast<Uint8>(a / count);
+        }
+    }
+
+    Image result;
+    result.create(size.x, size.y, out.data());
+    return result;
+}
+
+// Loads a texture no larger than the biggest size it can appear on screen
+// and builds its mipmaps. Adds the texture's memory at source resolution and
+// as uploaded (mip chain included) to the two totals.
+bool loadScaledTexture(Texture &texture, const string &file, Vector2f maxOnScreen,
+                       size_t &sourceBytes, size_t &loadedBytes)
+{
+    Image image;
+    if (!image.loadFromFile(file))
+        return false;
+
+    Vector2u sourceSize = image.getSize();
+    Vector2u size(min(sourceSize.x, static_cast<unsigned int>(ceil(maxOnScreen.x))),
+                  min(sourceSize.y, static_cast<unsigned int>(ceil(maxOnScreen.y))));
+    size.x = max(size.x, 1u);
+    size.y = max(size.y, 1u);
+
+    if (size.x != sourceSize.x || size.y != sourceSize.y)
+        image = downscaleImage(image, size);
+
+    if (!texture.loadFromImage(image))
+        return false;
+    texture.setSmooth(true);
+    if (!texture.generateMipmap())
+        cout << "[WARN] Mipmaps not supported for " << file << endl;
+
+    sourceBytes += static_cast<size_t>(sourceSize.x) * sourceSize.y * 4;
+    loadedBytes += static_cast<size_t>(size.x) * size.y * 4 * 4 / 3;
+    return true;
+}
+
+// One simulation tick of a run. Positions are stored relative to the road so
+// a ghost recorded on one screen size replays correctly on another.
+struct TrajectoryTick
+{
+    float deltaTime = 0.0f;
+    float carX = 0.0f;
+    float speed = 0.0f;
+    float zoom = 1.0f;
+    bool spawned = false;
+    int spawnTexture = 0;
+    float spawnX = 0.0f;
+};
+
+void writeVarint(ostream &out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.put(static_cast<char>(value));
+}
+
+bool readVarint(istream &in, uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        int byte = in.get();
+        if (byte == EOF)
+            return false;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+uint64_t zigzagEncode(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t zigzagDecode(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Trajectory file layout: the magic "CGT1" followed by one record per tick.
+// A record starts with varint (deltaMicros << 1 | spawned), then the
+// zigzag-varint deltas of the quantized car X, speed and zoom against the
+// previous tick, then varint texture index and spawn X when spawned.
+const char TRAJECTORY_MAGIC[4] = { 'C', 'G', 'T', '1' };
+const float TRAJECTORY_X_SCALE = 65536.0f;
+const float TRAJECTORY_SPEED_SCALE = 16.0f;
+const float TRAJECTORY_ZOOM_SCALE = 4096.0f;
+
+class TrajectoryWriter
+{
+public:
+    bool open(const string &path)
+    {
+        close();
+        out.open(path, ios::binary | ios::trunc);
+        if (!out.is_open())
+            return false;
+        out.write(TRAJECTORY_MAGIC, sizeof(TRAJECTORY_MAGIC));
+        lastX = lastSpeed = lastZoom = 0;
+        return true;
+    }
+
+    void record(const TrajectoryTick &tick)
+    {
+        if (!out.is_open())
+            return;
+
+        int64_t x = lround(tick.carX * TRAJECTORY_X_SCALE);
+        int64_t speed = lround(tick.speed * TRAJECTORY_SPEED_SCALE);
+        int64_t zoom = lround(tick.zoom * TRAJECTORY_ZOOM_SCALE);
+        uint64_t micros = static_cast<uint64_t>(llround(tick.deltaTime * 1e6f));
+
+        writeVarint(out, (micros << 1) | (tick.spawned ? 1u : 0u));
+        writeVarint(out, zigzagEncode(x - lastX));
+        writeVarint(out, zigzagEncode(speed - lastSpeed));
+        writeVarint(out, zigzagEncode(zoom - lastZoom));
+        if (tick.spawned)
+        {
+            writeVarint(out, static_cast<uint64_t>(tick.spawnTexture));
+            writeVarint(out, static_cast<uint64_t>(lround(tick.spawnX * TRAJECTORY_X_SCALE)));
+        }
+
+        lastX = x;
+        lastSpeed = speed;
+        lastZoom = zoom;
+    }
+
+    // Returns true only if a recording was open and every write reached the
+    // file, i.e. the file is safe to promote to the saved ghost.
+    bool close()
+    {
+        if (!out.is_open())
+            return false;
+        out.close();
+        return !out.fail();
+    }
+
+private:
+    ofstream out;
+    int64_t lastX = 0;
+    int64_t lastSpeed = 0;
+    int64_t lastZoom = 0;
+};
+
+// Streams a trajectory back one tick at a time; only the running totals are
+// kept in memory, never the whole run.
+class TrajectoryReader
+{
+public:
+    bool open(const string &path)
+    {
+        close();
+        in.open(path, ios::binary);
+        if (!in.is_open())
+            return false;
+
+        char magic[sizeof(TRAJECTORY_MAGIC)];
+        if (!in.read(magic, sizeof(magic)) || !equal(magic, magic + sizeof(magic), TRAJECTORY_MAGIC))
+        {
+            cout << "[WARN] Ignoring invalid ghost file." << endl;
+            close();
+            return false;
+        }
+        x = speed = 0;
+        zoom = 0;
+        return true;
+    }
+
+    bool next(TrajectoryTick &tick)
+    {
+        if (!in.is_open())
+            return false;
+
+        uint64_t header, dx, dSpeed, dZoom;
+        if (!readVarint(in, header) || !readVarint(in, dx) ||
+            !readVarint(in, dSpeed) || !readVarint(in, dZoom))
+        {
+            close();
+            return false;
+        }
+
+        x += zigzagDecode(dx);
+        speed += zigzagDecode(dSpeed);
+        zoom += zigzagDecode(dZoom);
+
+        tick.deltaTime = (header >> 1) / 1e6f;
+        tick.carX = x / TRAJECTORY_X_SCALE;
+        tick.speed = speed / TRAJECTORY_SPEED_SCALE;
+        tick.zoom = zoom / TRAJECTORY_ZOOM_SCALE;
+        tick.spawned = (header & 1) != 0;
+        if (tick.spawned)
+        {
+            uint64_t texture, spawnX;
+            if (!readVarint(in, texture) || !readVarint(in, spawnX))
+            {
+                close();
+                return false;
+            }
+            tick.spawnTexture = static_cast<int>(texture);
+            tick.spawnX = spawnX / TRAJECTORY_X_SCALE;
+        }
+        return true;
+    }
+
+    void close()
+    {
+        if (in.is_open())
+            in.close();
+    }
+
+private:
+    ifstream in;
+    int64_t x = 0;
+    int64_t speed = 0;
+    int64_t zoom = 0;
+};
+
+// Renders the scene into an offscreen texture at a fraction of the native
+// resolution and upscales it to the window. The fraction drops after a run
+// of consecutive over-budget frames and creeps back up after a stable
+// stretch. SFML has no GPU timer queries, so the frame interval stands in
+// for GPU time; requiring a sustained overrun keeps one-off CPU stalls
+// (logging, file I/O, parse bursts) from blurring the scene.
+class DynamicResolution
+{
+public:
+    bool create(Vector2u size)
+    {
+        nativeSize = size;
+        scaledSize = size;
+        if (!target.create(size.x, size.y))
+            return false;
+        target.setSmooth(true);
+        return true;
+    }
+
+    void update(float frameSeconds)
+    {
+        if (frameSeconds > FRAME_BUDGET * 1.15f)
+        {
+            ++overBudgetFrames;
+            withinBudgetFrames = 0;
+        }
+        else if (frameSeconds < FRAME_BUDGET * 1.05f)
+        {
+            ++withinBudgetFrames;
+            overBudgetFrames = 0;
+        }
+
+        float newScale = scale;
+        if (overBudgetFrames >= 30)
+            newScale = max(MIN_RENDER_SCALE, scale - 0.1f);
+        else if (withinBudgetFrames >= 120)
+            newScale = min(1.0f, scale + 0.05f);
+
+        if (newScale != scale)
+        {
+            scale = newScale;
+            scaledSize.x = static_cast<unsigned int>(nativeSize.x * scale + 0.5f);
+            scaledSize.y = static_cast<unsigned int>(nativeSize.y * scale + 0.5f);
+        }
+        if (overBudgetFrames >= 30 || withinBudgetFrames >= 120)
+            reset();
+    }
+
+    // Forgets the frame history, e.g. across game state changes whose
+    // loading work would otherwise count as an overrun.
+    void reset()
+    {
+        overBudgetFrames = 0;
+        withinBudgetFrames = 0;
+    }
+
+    RenderTexture &begin(const View &sceneView)
+    {
+        View view = sceneView;
+        view.setViewport(FloatRect(0.0f, 0.0f,
+                                   static_cast<float>(scaledSize.x) / nativeSize.x,
+                                   static_cast<float>(scaledSize.y) / nativeSize.y));
+        target.setView(view);
+        target.clear();
+        return target;
+    }
+
+    void present(RenderWindow &window)
+    {
+        target.display();
+
+        Sprite frame(target.getTexture(), IntRect(0, 0, scaledSize.x, scaledSize.y));
+        frame.setScale(static_cast<float>(nativeSize.x) / scaledSize.x,
+                       static_cast<float>(nativeSize.y) / scaledSize.y);
+        window.draw(frame);
+    }
+
+private:
+    RenderTexture target;
+    Vector2u nativeSize;
+    Vector2u scaledSize;
+    float scale = 1.0f;
+    int overBudgetFrames = 0;
+    int withinBudgetFrames = 0;
+};
+
 int main(int argc, char *argv[])
 {
     if (argc != 3)
@@ -109,6 +834,15 @@ int main(int argc, char *argv[])
     RenderWindow window(desktop, "Car Steering Game", Style::Fullscreen);
     window.setFramerateLimit(60);
 
+    DynamicResolution dynamicResolution;
+    if (!dynamicResolution.create(screenSize))
+    {
+        cout << "Failed to create scene render texture." << endl;
+        return 1;
+    }
+
+    View sceneView = window.getDefaultView();
+
     float roadWidth = screenSize.x * 0.5f;
 
     const float BUFFER_Y = screenSize.y * BUFFER_Y_FACTOR; 
@@ -133,8 +867,20 @@ int main(int argc, char *argv[])
     }
 
     
+    // Sprites are magnified the most at MIN_ZOOM_IN, so textures never need
+    // more pixels than that. The shipped 50x100 images are already smaller
+    // on any common screen, so they are only mipmapped and the report's
+    // second figure is just the mip chain on top of the first.
+    size_t sourceTextureBytes = 0;
+    size_t loadedTextureBytes = 0;
+
+    float carWidth = screenSize.x * 0.0625f;
+    float carHeight = screenSize.y * 0.166f;
+
     Texture carTexture;
-    if (!carTexture.loadFromFile("assets/images/car.png"))
+    if (!loadScaledTexture(carTexture, "assets/images/car.png",
+                           Vector2f(carWidth / MIN_ZOOM_IN, carHeight / MIN_ZOOM_IN),
+                           sourceTextureBytes, loadedTextureBytes))
     {
         cout << "Failed to load car texture." << endl;
         return 1;
@@ -142,31 +888,37 @@ int main(int argc, char *argv[])
 
     Sprite car(carTexture);
 
-    float carWidth = screenSize.x * 0.0625f;
-    float carHeight = screenSize.y * 0.166f;
     car.setScale(carWidth / carTexture.getSize().x, carHeight / carTexture.getSize().y);
 
     car.setPosition(
         road.getPosition().x + roadWidth / 2.0f - carWidth / 2.0f,
         screenSize.y - carHeight - screenSize.y * 0.05f);
+
+    Sprite ghostCar(car);
+    ghostCar.setColor(Color(255, 255, 255, 100));
     
 
+    float obstacleWidth = screenSize.x * 0.0625f;
+    float obstacleHeight = screenSize.y * 0.133f;
+
     vector<Texture> obstacleTextures;
     string obstacleFiles[] = { "assets/images/obstacle1.png", "assets/images/obstacle2.png", "assets/images/obstacle3.png" };
+    // Loaded in place: copying a Texture drops its mipmaps.
+    obstacleTextures.reserve(sizeof(obstacleFiles) / sizeof(obstacleFiles[0]));
     for (const auto &file : obstacleFiles)
     {
-        Texture tex;
-        if (!tex.loadFromFile(file))
+        obstacleTextures.emplace_back();
+        if (!loadScaledTexture(obstacleTextures.back(), file,
+                               Vector2f(obstacleWidth / MIN_ZOOM_IN, obstacleHeight / MIN_ZOOM_IN),
+                               sourceTextureBytes, loadedTextureBytes))
         {
             cout << "Failed to load obstacle texture: " << file << endl;
             return 1;
         }
-        tex.setSmooth(true);
-        obstacleTextures.push_back(tex);
     }
 
-    float obstacleWidth = screenSize.x * 0.0625f;
-    float obstacleHeight = screenSize.y * 0.133f;
+    cout << "Texture memory: " << sourceTextureBytes / 1024 << " KiB at source resolution, "
+         << loadedTextureBytes / 1024 << " KiB resampled with mipmaps." << endl;
 
     vector<Sprite> obstacles;
     srand(static_cast<unsigned int>(time(0)));
@@ -191,10 +943,11 @@ int main(int argc, char *argv[])
     int calibrationSamples = 0;
     const int maxCalibrationSamples = 100;
 
-    deque<double> gyroXBuffer;
-    deque<double> gyroYBuffer;
-    deque<double> gyroZBuffer;
-    const size_t bufferSize = 10;
+    double accelXReference = 0.0;
+    double accelYReference = 0.0;
+    double accelZReference = 0.0;
+
+    TiltFilter tiltFilter;
 
     const float movementScalingFactor = 300.0f;
     const float zoomSpeed = 0.1f;
@@ -204,6 +957,7 @@ int main(int argc, char *argv[])
     bool isCalibrating = true;
 
     GameState currentState = GameState::MainMenu;
+    GameState previousState = currentState;
 
 
     Font font;
@@ -262,6 +1016,16 @@ int main(int argc, char *argv[])
 
     Clock scoreClock;
 
+    Metrics metrics(METRICS_FILE);
+
+    TrajectoryWriter ghostRecorder;
+    TrajectoryReader ghostReader;
+    TrajectoryTick ghostTick;
+    bool ghostActive = false;
+    float ghostTime = 0.0f;
+    float ghostTickTime = 0.0f;
+    Clock frameClock;
+
     float currentSpeed = 400.0f; 
     const float maxSpeed = 800.0f; 
     const float minSpeed = 200.0f; 
@@ -272,17 +1036,8 @@ int main(int argc, char *argv[])
     
 
     
-    SoundBuffer carMoveBuffer;
-    if (!carMoveBuffer.loadFromFile("assets/sounds/car_move.wav"))
-    {
-        cout << "Failed to load car movement sound." << endl;
-        return 1;
-    }
-
-    Sound carMoveSound;
-    carMoveSound.setBuffer(carMoveBuffer);
-    carMoveSound.setLoop(true); 
-    carMoveSound.setVolume(50.0f); 
+    EngineSound engineSound(minSpeed, maxSpeed);
+    engineSound.setVolume(50.0f); 
 
 
     SoundBuffer carCollisionBuffer;
@@ -300,6 +1055,21 @@ int main(int argc, char *argv[])
 
     while (window.isOpen())
     {
+        float frameSeconds = frameClock.restart().asSeconds();
+        metrics.countFrame(frameSeconds);
+
+        // The frame that changed state carries its file and socket work, so
+        // it says nothing about render cost.
+        if (currentState != previousState)
+        {
+            dynamicResolution.reset();
+            previousState = currentState;
+        }
+        else
+        {
+            dynamicResolution.update(frameSeconds);
+        }
+
         Event event;
         while (window.pollEvent(event))
         {
@@ -321,22 +1091,30 @@ int main(int argc, char *argv[])
                         gyroYOffset = 0.0;
                         gyroZOffset = 0.0;
                         calibrationSamples = 0;
-                        gyroXBuffer.clear();
-                        gyroYBuffer.clear();
-                        gyroZBuffer.clear();
+                        accelXReference = 0.0;
+                        accelYReference = 0.0;
+                        accelZReference = 0.0;
 
                         obstacles.clear();
                         gameOver = false;
                         gameClock.restart();
                         obstacleClock.restart();
+
+                        if (!ghostRecorder.open(GHOST_RECORDING_FILE))
+                        {
+                            cout << "[WARN] Unable to record ghost run." << endl;
+                        }
+                        ghostActive = ghostReader.open(GHOST_FILE) && ghostReader.next(ghostTick);
+                        ghostTime = 0.0f;
+                        ghostTickTime = ghostTick.deltaTime;
                         score = 0.0f; 
                         scoreClock.restart(); 
 
                         currentZoom = 1.0f;
-                        window.setView(window.getDefaultView());
+                        sceneView = window.getDefaultView();
 
                         
-                        carMoveSound.play();
+                        engineSound.play();
                         
                     }
                     if (quitButton.isClicked(mousePos))
@@ -356,22 +1134,30 @@ int main(int argc, char *argv[])
                         gyroYOffset = 0.0;
                         gyroZOffset = 0.0;
                         calibrationSamples = 0;
-                        gyroXBuffer.clear();
-                        gyroYBuffer.clear();
-                        gyroZBuffer.clear();
+                        accelXReference = 0.0;
+                        accelYReference = 0.0;
+                        accelZReference = 0.0;
 
                         obstacles.clear();
                         gameOver = false;
                         gameClock.restart();
                         obstacleClock.restart();
+
+                        if (!ghostRecorder.open(GHOST_RECORDING_FILE))
+                        {
+                            cout << "[WARN] Unable to record ghost run." << endl;
+                        }
+                        ghostActive = ghostReader.open(GHOST_FILE) && ghostReader.next(ghostTick);
+                        ghostTime = 0.0f;
+                        ghostTickTime = ghostTick.deltaTime;
                         score = 0.0f; 
                         scoreClock.restart(); 
 
                         currentZoom = 1.0f;
-                        window.setView(window.getDefaultView());
+                        sceneView = window.getDefaultView();
 
                         
-                        carMoveSound.play();
+                        engineSound.play();
                         
                     }
                     if (gameOverQuitButton.isClicked(mousePos))
@@ -391,6 +1177,7 @@ int main(int argc, char *argv[])
             if (status == Socket::Done)
             {
                 buffer[received] = '\0';
+                metrics.countBytesReceived(received, received == sizeof(buffer) - 1);
                 residual_data += string(buffer, received);
 
                 size_t pos;
@@ -398,6 +1185,7 @@ int main(int argc, char *argv[])
                 {
                     string line = residual_data.substr(0, pos);
                     residual_data.erase(0, pos + 1);
+                    metrics.countLine();
 
                     if (line.empty() || line.find("loggingTime") != string::npos)
                     {
@@ -413,19 +1201,30 @@ int main(int argc, char *argv[])
                             double currentGyroX = -stod(values[GYRO_X_INDEX]);
                             double currentGyroY = -stod(values[GYRO_Y_INDEX]);
                             double currentGyroZ = -stod(values[GYRO_Z_INDEX]);
+                            double currentAccelX = stod(values[ACCEL_X_INDEX]);
+                            double currentAccelY = stod(values[ACCEL_Y_INDEX]);
+                            double currentAccelZ = stod(values[ACCEL_Z_INDEX]);
 
                             if (isCalibrating)
                             {
                                 gyroXOffset += currentGyroX;
                                 gyroYOffset += currentGyroY;
                                 gyroZOffset += currentGyroZ;
+                                accelXReference += currentAccelX;
+                                accelYReference += currentAccelY;
+                                accelZReference += currentAccelZ;
                                 calibrationSamples++;
                                 if (calibrationClock.getElapsedTime().asSeconds() >= calibrationDuration || calibrationSamples >= maxCalibrationSamples)
                                 {
                                     gyroXOffset /= calibrationSamples;
                                     gyroYOffset /= calibrationSamples;
                                     gyroZOffset /= calibrationSamples;
+                                    tiltFilter.reset(accelXReference / calibrationSamples,
+                                                     accelYReference / calibrationSamples,
+                                                     accelZReference / calibrationSamples);
+                                    gyroX = gyroY = gyroZ = 0.0;
                                     isCalibrating = false;
+                                    metrics.observeCalibration(calibrationClock.getElapsedTime().asSeconds());
                                     cout << "Calibration complete. GyroX Offset: " << gyroXOffset
                                          << ", GyroY Offset: " << gyroYOffset
                                          << ", GyroZ Offset: " << gyroZOffset << endl;
@@ -433,33 +1232,39 @@ int main(int argc, char *argv[])
                                 }
                             }
                         }
-                        catch (const invalid_argument &e)
+                        catch (const logic_error &e)
                         {
                             cout << "[ERROR] Invalid gyroscope value: " << e.what() << endl;
+                            metrics.countParseError();
                         }
                     }
                     else
                     {
                         cout << "[WARN] Incomplete data line received. Skipping." << endl;
+                        metrics.countIncompleteLine();
                     }
                 }
             }
             else if (status == Socket::Disconnected)
             {
                 cout << "Sensor server disconnected." << endl;
+                metrics.countDisconnect();
                 currentState = GameState::MainMenu;
             }
 
-            window.clear();
+            RenderTexture &scene = dynamicResolution.begin(sceneView);
 
-            window.draw(road);
+            scene.draw(road);
             for (auto &mark : laneMarks)
-                window.draw(mark);
+                scene.draw(mark);
 
-            window.draw(car);
+            scene.draw(car);
 
             for (auto &obstacle : obstacles)
-                window.draw(obstacle);
+                scene.draw(obstacle);
+
+            window.clear();
+            dynamicResolution.present(window);
 
             Text calibrationText("Calibrating...\nPlease keep your device steady.", font, static_cast<unsigned int>(screenSize.y * 0.04f));
             calibrationText.setFillColor(Color::Yellow);
@@ -484,6 +1289,7 @@ int main(int argc, char *argv[])
                 if (status == Socket::Done)
                 {
                     buffer[received] = '\0';
+                    metrics.countBytesReceived(received, received == sizeof(buffer) - 1);
                     residual_data += string(buffer, received);
 
                     size_t pos;
@@ -491,6 +1297,7 @@ int main(int argc, char *argv[])
                     {
                         string line = residual_data.substr(0, pos);
                         residual_data.erase(0, pos + 1);
+                        metrics.countLine();
 
                         if (line.empty() || line.find("loggingTime") != string::npos)
                         {
@@ -506,80 +1313,47 @@ int main(int argc, char *argv[])
                                 double currentGyroX = -stod(values[GYRO_X_INDEX]);
                                 double currentGyroY = -stod(values[GYRO_Y_INDEX]);
                                 double currentGyroZ = -stod(values[GYRO_Z_INDEX]);
-
-                                double calibratedGyroX = currentGyroX - gyroXOffset;
-                                double calibratedGyroY = currentGyroY - gyroYOffset;
-                                double calibratedGyroZ = currentGyroZ - gyroZOffset;
-
-                                gyroXBuffer.push_back(calibratedGyroX);
-                                if (gyroXBuffer.size() > bufferSize)
-                                {
-                                    gyroXBuffer.pop_front();
-                                }
-
-                                double sumX = 0.0;
-                                for (const auto &val : gyroXBuffer)
-                                {
-                                    sumX += val;
-                                }
-                                double averageGyroX = sumX / gyroXBuffer.size();
-
-                                averageGyroX = clamp(averageGyroX, -10.0, 10.0);
-
-                                gyroX = averageGyroX;
-
-                                gyroYBuffer.push_back(calibratedGyroY);
-                                if (gyroYBuffer.size() > bufferSize)
-                                {
-                                    gyroYBuffer.pop_front();
-                                }
-
-                                double sumY = 0.0;
-                                for (const auto &val : gyroYBuffer)
-                                {
-                                    sumY += val;
-                                }
-                                double averageGyroY = sumY / gyroYBuffer.size();
-
-                                averageGyroY = clamp(averageGyroY, -10.0, 10.0);
-
-                                gyroY = averageGyroY;
-
-                                gyroZBuffer.push_back(calibratedGyroZ);
-                                if (gyroZBuffer.size() > bufferSize)
-                                {
-                                    gyroZBuffer.pop_front();
-                                }
-
-                                double sumZ = 0.0;
-                                for (const auto &val : gyroZBuffer)
-                                {
-                                    sumZ += val;
-                                }
-                                double averageGyroZ = sumZ / gyroZBuffer.size();
-
-                                averageGyroZ = clamp(averageGyroZ, -10.0, 10.0);
-
-                                gyroZ = averageGyroZ;
+                                double currentAccelX = stod(values[ACCEL_X_INDEX]);
+                                double currentAccelY = stod(values[ACCEL_Y_INDEX]);
+                                double currentAccelZ = stod(values[ACCEL_Z_INDEX]);
+                                double timestamp = stod(values[GYRO_TIMESTAMP_INDEX]);
+
+                                tiltFilter.update(currentGyroX - gyroXOffset,
+                                                  currentGyroY - gyroYOffset,
+                                                  currentGyroZ - gyroZOffset,
+                                                  currentAccelX, currentAccelY, currentAccelZ,
+                                                  timestamp);
+
+                                gyroX = clamp(tiltFilter.getAngleX() * TILT_CONTROL_GAIN, -10.0, 10.0);
+                                gyroY = clamp(tiltFilter.getAngleY() * TILT_CONTROL_GAIN, -10.0, 10.0);
+                                gyroZ = clamp(tiltFilter.getAngleZ() * TILT_CONTROL_GAIN, -10.0, 10.0);
                             }
-                            catch (const invalid_argument &e)
+                            catch (const logic_error &e)
                             {
                                 cout << "[ERROR] Invalid gyroscope value: " << e.what() << endl;
+                                metrics.countParseError();
                             }
                         }
                         else
                         {
                             cout << "[WARN] Incomplete data line received. Skipping." << endl;
+                            metrics.countIncompleteLine();
                         }
                     }
                 }
                 else if (status == Socket::Disconnected)
                 {
                     cout << "Sensor server disconnected." << endl;
+                    metrics.countDisconnect();
+                    metrics.observeSessionScore(score);
                     currentState = GameState::MainMenu;
 
+                    ghostRecorder.close();
+                    ghostReader.close();
+                    ghostActive = false;
+
                     
-                    carMoveSound.stop();
+                    engineSound.stop();
                     
                 }
 
@@ -602,6 +1376,9 @@ int main(int argc, char *argv[])
                 
                 currentSpeed = clamp(currentSpeed, minSpeed, maxSpeed);
 
+                engineSound.setSpeed(currentSpeed);
+                engineSound.setSteering(static_cast<float>(gyroZ) / 10.0f);
+
 
                 float movement = static_cast<float>(gyroZ) * movementScalingFactor * deltaTime;
                 car.move(movement, 0.0f);
@@ -614,14 +1391,18 @@ int main(int argc, char *argv[])
 
 
                 currentZoom += static_cast<float>(gyroY) * zoomSpeed * deltaTime;
-                currentZoom = clamp(currentZoom, 0.5f, MAX_ZOOM_OUT); 
+                currentZoom = clamp(currentZoom, MIN_ZOOM_IN, MAX_ZOOM_OUT); 
 
-                View view = window.getView();
-                view.setSize(screenSize.x * currentZoom, screenSize.y * currentZoom);
-                view.setCenter(screenSize.x / 2.0f, screenSize.y / 2.0f); 
-                window.setView(view);
+                sceneView.setSize(screenSize.x * currentZoom, screenSize.y * currentZoom);
+                sceneView.setCenter(screenSize.x / 2.0f, screenSize.y / 2.0f); 
 
 
+                TrajectoryTick tick;
+                tick.deltaTime = deltaTime;
+                tick.carX = (car.getPosition().x - road.getPosition().x) / roadWidth;
+                tick.speed = currentSpeed;
+                tick.zoom = currentZoom;
+
                 if (obstacleClock.getElapsedTime().asSeconds() > obstacleSpawnTime)
                 {
                     Sprite obstacle;
@@ -634,6 +1415,22 @@ int main(int argc, char *argv[])
                     obstacle.setPosition(xPos, -BUFFER_Y - obstacleHeight); 
                     obstacles.push_back(obstacle);
                     obstacleClock.restart();
+
+                    tick.spawned = true;
+                    tick.spawnTexture = texIndex;
+                    tick.spawnX = (xPos - road.getPosition().x) / roadWidth;
+                }
+
+                ghostRecorder.record(tick);
+
+                // Only the ghost's X is replayed. Speed, zoom and obstacle
+                // spawns are recorded so a run can later be replayed in full.
+                ghostTime += deltaTime;
+                while (ghostActive && ghostTickTime <= ghostTime)
+                {
+                    ghostCar.setPosition(road.getPosition().x + ghostTick.carX * roadWidth, car.getPosition().y);
+                    ghostActive = ghostReader.next(ghostTick);
+                    ghostTickTime += ghostTick.deltaTime;
                 }
 
 
@@ -668,14 +1465,30 @@ int main(int argc, char *argv[])
 
                         
                         carCollisionSound.play();
+                        metrics.observeSessionScore(score);
 
                         
-                        carMoveSound.stop();
+                        engineSound.stop();
+
+                        bool ghostRecorded = ghostRecorder.close();
+                        ghostReader.close();
+                        ghostActive = false;
 
                         
                         if (score > highScore)
                         {
                             highScore = score;
+
+                            // rename replaces the target atomically on POSIX;
+                            // only remove the old ghost where it refuses to.
+                            if (ghostRecorded && rename(GHOST_RECORDING_FILE, GHOST_FILE) != 0)
+                            {
+                                remove(GHOST_FILE);
+                                if (rename(GHOST_RECORDING_FILE, GHOST_FILE) != 0)
+                                {
+                                    cout << "[ERROR] Unable to save ghost run." << endl;
+                                }
+                            }
                             
                             ofstream highScoreOut("highscore.txt");
                             if (highScoreOut.is_open())
@@ -694,16 +1507,22 @@ int main(int argc, char *argv[])
                 }
             }
 
-            window.clear();
+            RenderTexture &scene = dynamicResolution.begin(sceneView);
 
-            window.draw(road);
+            scene.draw(road);
             for (auto &mark : laneMarks)
-                window.draw(mark);
+                scene.draw(mark);
 
-            window.draw(car);
+            if (ghostActive)
+                scene.draw(ghostCar);
+
+            scene.draw(car);
 
             for (auto &obstacle : obstacles)
-                window.draw(obstacle);
+                scene.draw(obstacle);
+
+            window.clear();
+            dynamicResolution.present(window);
 
 
             Text scoreText;
@@ -728,16 +1547,19 @@ int main(int argc, char *argv[])
         else if (currentState == GameState::GameOver)
         {
 
-            window.clear();
+            RenderTexture &scene = dynamicResolution.begin(sceneView);
 
-            window.draw(road);
+            scene.draw(road);
             for (auto &mark : laneMarks)
-                window.draw(mark);
+                scene.draw(mark);
 
-            window.draw(car);
+            scene.draw(car);
 
             for (auto &obstacle : obstacles)
-                window.draw(obstacle);
+                scene.draw(obstacle);
+
+            window.clear();
+            dynamicResolution.present(window);
 
 
             Text gameOverText("Game Over", font, static_cast<unsigned int>(screenSize.y * 0.08f));
@@ -777,16 +1599,19 @@ int main(int argc, char *argv[])
         else if (currentState == GameState::MainMenu)
         {
 
-            window.clear();
+            RenderTexture &scene = dynamicResolution.begin(sceneView);
 
-            window.draw(road);
+            scene.draw(road);
             for (auto &mark : laneMarks)
-                window.draw(mark);
+                scene.draw(mark);
 
-            window.draw(car);
+            scene.draw(car);
 
             for (auto &obstacle : obstacles)
-                window.draw(obstacle);
+                scene.draw(obstacle);
+
+            window.clear();
+            dynamicResolution.present(window);
 
 
             Text title("Car Steering Game", font, static_cast<unsigned int>(screenSize.y * 0.1f));
@@ -0,0 +1,373 @@
+#include <SFML/Network.hpp>
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <fstream>
+#include <random>
+#include <cmath>
+#include <ctime>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+
+using namespace std;
+using namespace sf;
+
+// Stand-in for the phone's sensor-logging app. Streams the same CSV layout
+// the game parses (gyro in columns 25-27) at a configurable rate, optionally
+// in bursts, with lines split across TCP segments and malformed fields.
+
+const int COLUMN_COUNT = 28;
+const int ACCEL_TIMESTAMP_INDEX = 20;
+const int ACCEL_X_INDEX = 21;
+const int GYRO_TIMESTAMP_INDEX = 24;
+const int GYRO_X_INDEX = 25;
+
+const char *const HEADER_LINE =
+    "loggingTime(txt),loggingSample(N),identifierForVendor(txt),deviceID(txt),"
+    "locationTimestamp_since1970(s),locationLatitude(WGS84),locationLongitude(WGS84),"
+    "locationAltitude(m),locationSpeed(m/s),locationCourse(°),locationVerticalAccuracy(m),"
+    "locationHorizontalAccuracy(m),locationFloor(Z),locationHeadingTimestamp_since1970(s),"
+    "locationHeadingX(µT),locationHeadingY(µT),locationHeadingZ(µT),locationTrueHeading(°),"
+    "locationMagneticHeading(°),locationHeadingAccuracy(°),accelerometerTimestamp_sinceReboot(s),"
+    "accelerometerAccelerationX(G),accelerometerAccelerationY(G),accelerometerAccelerationZ(G),"
+    "gyroTimestamp_sinceReboot(s),gyroRotationX(rad/s),gyroRotationY(rad/s),gyroRotationZ(rad/s)\n";
+
+struct Options
+{
+    unsigned short port = 0;
+    double rate = 100.0;
+    int burst = 1;
+    double splitChance = 0.0;
+    double malformedChance = 0.0;
+    double noise = 0.01;
+    double duration = 0.0;
+    string profile = "sine";
+    unsigned int seed = 0;
+};
+
+struct Keyframe
+{
+    double time;
+    double angle[3];
+};
+
+// Device tilt (radians about the X, Y and Z axes) over time. Built-in
+// profiles are closed-form; anything else is read as a script file of
+// "time angleX angleY angleZ" keyframes that are linearly interpolated
+// and looped.
+class SteeringProfile
+{
+public:
+    bool load(const string &name)
+    {
+        this->name = name;
+        if (name == "still" || name == "sine" || name == "zigzag" || name == "step")
+            return true;
+
+        ifstream script(name);
+        if (!script.is_open())
+            return false;
+
+        string line;
+        while (getline(script, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+            Keyframe frame;
+            stringstream ss(line);
+            if (ss >> frame.time >> frame.angle[0] >> frame.angle[1] >> frame.angle[2])
+                keyframes.push_back(frame);
+        }
+        return !keyframes.empty();
+    }
+
+    void sample(double t, double angle[3]) const
+    {
+        const double twoPi = 6.283185307179586;
+        angle[0] = angle[1] = angle[2] = 0.0;
+
+        if (name == "still")
+        {
+            return;
+        }
+        else if (name == "sine")
+        {
+            angle[0] = 0.15 * sin(twoPi * 0.10 * t);
+            angle[1] = 0.10 * sin(twoPi * 0.05 * t);
+            angle[2] = 0.40 * sin(twoPi * 0.25 * t);
+        }
+        else if (name == "zigzag")
+        {
+            double phase = fmod(t, 4.0) / 4.0;
+            angle[2] = 0.4 * (phase < 0.5 ? 4.0 * phase - 1.0 : 3.0 - 4.0 * phase);
+        }
+        else if (name == "step")
+        {
+            // Alternate hard left/right every two seconds with a short ramp.
+            double phase = fmod(t, 4.0);
+            double ramp = min(fmod(phase, 2.0) / 0.2, 1.0);
+            double target = phase < 2.0 ? 0.3 : -0.3;
+            angle[2] = -target + 2.0 * target * ramp;
+        }
+        else
+        {
+            double end = keyframes.back().time;
+            double local = end > 0.0 ? fmod(t, end) : 0.0;
+            size_t next = 0;
+            while (next < keyframes.size() && keyframes[next].time < local)
+                ++next;
+            if (next == 0 || next == keyframes.size())
+            {
+                const Keyframe &frame = next == 0 ? keyframes.front() : keyframes.back();
+                copy(frame.angle, frame.angle + 3, angle);
+                return;
+            }
+            const Keyframe &a = keyframes[next - 1];
+            const Keyframe &b = keyframes[next];
+            double f = (local - a.time) / (b.time - a.time);
+            for (int i = 0; i < 3; ++i)
+                angle[i] = a.angle[i] + (b.angle[i] - a.angle[i]) * f;
+        }
+    }
+
+private:
+    string name;
+    vector<Keyframe> keyframes;
+};
+
+void printUsage()
+{
+    cout << "Usage: ./sensor_server <Port> [--rate Hz] [--burst lines] [--split chance]\n"
+            "                       [--malformed chance] [--noise rad/s] [--duration s]\n"
+            "                       [--profile still|sine|zigzag|step|<script file>] [--seed n]"
+         << endl;
+}
+
+bool parseOptions(int argc, char *argv[], Options &options)
+{
+    if (argc < 2)
+        return false;
+
+    try
+    {
+        options.port = static_cast<unsigned short>(stoi(argv[1]));
+        for (int i = 2; i + 1 < argc; i += 2)
+        {
+            string flag = argv[i];
+            string value = argv[i + 1];
+            if (flag == "--rate")
+                options.rate = stod(value);
+            else if (flag == "--burst")
+                options.burst = max(1, stoi(value));
+            else if (flag == "--split")
+                options.splitChance = stod(value);
+            else if (flag == "--malformed")
+                options.malformedChance = stod(value);
+            else if (flag == "--noise")
+                options.noise = stod(value);
+            else if (flag == "--duration")
+                options.duration = stod(value);
+            else if (flag == "--profile")
+                options.profile = value;
+            else if (flag == "--seed")
+                options.seed = static_cast<unsigned int>(stoul(value));
+            else
+                return false;
+        }
+        if (argc % 2 != 0)
+            return false;
+    }
+    catch (const logic_error &)
+    {
+        return false;
+    }
+
+    return options.rate > 0.0;
+}
+
+string loggingTime()
+{
+    time_t now = time(nullptr);
+    char text[64];
+    strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S +0000", gmtime(&now));
+    return text;
+}
+
+// Replaces one sensor field with something the parser must survive: text,
+// an empty field, a value outside double range, or a truncated line.
+void corrupt(vector<string> &fields, mt19937 &rng)
+{
+    uniform_int_distribution<int> kind(0, 3);
+    uniform_int_distribution<int> column(ACCEL_X_INDEX, COLUMN_COUNT - 1);
+    switch (kind(rng))
+    {
+    case 0:
+        fields[column(rng)] = "abc";
+        break;
+    case 1:
+        fields[column(rng)] = "";
+        break;
+    case 2:
+        fields[column(rng)] = "1e999";
+        break;
+    default:
+        fields.resize(GYRO_X_INDEX + 1);
+        break;
+    }
+}
+
+string makeLine(long long sample, double t, const SteeringProfile &profile,
+                const Options &options, mt19937 &rng)
+{
+    const double h = 0.001;
+    double angle[3];
+    double ahead[3];
+    profile.sample(t, angle);
+    profile.sample(t + h, ahead);
+
+    normal_distribution<double> noise(0.0, options.noise);
+    double gyro[3];
+    for (int i = 0; i < 3; ++i)
+        gyro[i] = (ahead[i] - angle[i]) / h + noise(rng);
+
+    // Phone held upright in landscape: gravity along -X at rest. Small-angle
+    // rotation of that vector gives the accelerometer reading in G.
+    double accel[3] = { -1.0, angle[2], -angle[1] };
+    double norm = sqrt(accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2]);
+    for (int i = 0; i < 3; ++i)
+        accel[i] = accel[i] / norm + noise(rng) * 0.1;
+
+    vector<string> fields(COLUMN_COUNT, "0");
+    fields[0] = loggingTime();
+    fields[1] = to_string(sample);
+    fields[2] = "00000000-0000-0000-0000-000000000000";
+    fields[3] = "sensor_server";
+    fields[ACCEL_TIMESTAMP_INDEX] = to_string(t);
+    fields[GYRO_TIMESTAMP_INDEX] = to_string(t);
+    for (int i = 0; i < 3; ++i)
+    {
+        fields[ACCEL_X_INDEX + i] = to_string(accel[i]);
+        fields[GYRO_X_INDEX + i] = to_string(gyro[i]);
+    }
+
+    uniform_real_distribution<double> chance(0.0, 1.0);
+    if (chance(rng) < options.malformedChance)
+        corrupt(fields, rng);
+
+    string line;
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+        if (i > 0)
+            line += ',';
+        line += fields[i];
+    }
+    line += '\n';
+    return line;
+}
+
+bool sendAll(TcpSocket &client, const string &data)
+{
+    return client.send(data.data(), data.size()) == Socket::Done;
+}
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage();
+        return 1;
+    }
+
+    SteeringProfile profile;
+    if (!profile.load(options.profile))
+    {
+        cout << "Failed to load steering profile: " << options.profile << endl;
+        return 1;
+    }
+
+    TcpListener listener;
+    if (listener.listen(options.port) != Socket::Done)
+    {
+        cout << "Failed to listen on port " << options.port << "." << endl;
+        return 1;
+    }
+
+    mt19937 rng(options.seed);
+    uniform_real_distribution<double> chance(0.0, 1.0);
+
+    while (true)
+    {
+        cout << "Waiting for the game on port " << options.port << "..." << endl;
+
+        TcpSocket client;
+        if (listener.accept(client) != Socket::Done)
+            continue;
+
+        cout << "Client connected from " << client.getRemoteAddress().toString() << endl;
+
+        if (!sendAll(client, HEADER_LINE))
+            continue;
+
+        Clock clock;
+        Clock reportClock;
+        long long sample = 0;
+        long long reportLines = 0;
+        size_t reportBytes = 0;
+        bool connected = true;
+
+        while (connected)
+        {
+            double elapsed = clock.getElapsedTime().asSeconds();
+            if (options.duration > 0.0 && elapsed >= options.duration)
+                break;
+
+            long long due = static_cast<long long>(elapsed * options.rate) - sample;
+            if (due < options.burst)
+            {
+                this_thread::sleep_for(chrono::microseconds(200));
+                continue;
+            }
+
+            // Never send more than one burst at a time; if the game stops
+            // draining the socket the schedule slips and shows up as lag.
+            string batch;
+            for (int i = 0; i < options.burst; ++i, ++sample)
+                batch += makeLine(sample, sample / options.rate, profile, options, rng);
+
+            if (chance(rng) < options.splitChance)
+            {
+                uniform_int_distribution<size_t> cut(1, batch.size() - 1);
+                size_t at = cut(rng);
+                connected = sendAll(client, batch.substr(0, at));
+                this_thread::sleep_for(chrono::microseconds(500));
+                connected = connected && sendAll(client, batch.substr(at));
+            }
+            else
+            {
+                connected = sendAll(client, batch);
+            }
+
+            reportLines += options.burst;
+            reportBytes += batch.size();
+
+            if (reportClock.getElapsedTime().asSeconds() >= 1.0f)
+            {
+                float interval = reportClock.restart().asSeconds();
+                long long lag = static_cast<long long>(clock.getElapsedTime().asSeconds() * options.rate) - sample;
+                cout << "[STATS] " << static_cast<long long>(reportLines / interval) << " lines/s, "
+                     << static_cast<long long>(reportBytes / interval) << " bytes/s, "
+                     << "lag " << lag << " lines" << endl;
+                reportLines = 0;
+                reportBytes = 0;
+            }
+        }
+
+        cout << "Client disconnected after " << sample << " lines." << endl;
+        client.disconnect();
+    }
+
+    return 0;
+}